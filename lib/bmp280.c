@@ -18,8 +18,19 @@
 
 #include "bmp280.h"
 
+_Static_assert(SPI_DATABUF_SIZE >= BMP280_SPI_DATABUF_SIZE, "SPI_DATABUF_SIZE is too small for bmp280");
+#if (_T_REUSE_MODE_ == 1)
+_Static_assert(BMP280_T_REUSE_PERIOD >= 1 && BMP280_T_REUSE_PERIOD <= 128 &&
+				   (BMP280_T_REUSE_PERIOD & (BMP280_T_REUSE_PERIOD - 1)) == 0,
+			   "BMP280_T_REUSE_PERIOD must be a power of 2 in 1...128");
+#endif
+
 BMP280 bmp280;
+#if (_MIN_FOOTPRINT_ == 1)
+static const ncs_io bmp280_ncs = {BMP280_CSB_GPIO_Port, BMP280_CSB_Pin}; // kept in flash
+#else
 static ncs_io bmp280_ncs;
+#endif
 
 /*** basic bmp280 operate ***/
 /*
@@ -41,6 +52,7 @@ static void bmp280_r_regs(uint8_t reg_addr, uint8_t num)
 {
 	spi_r_bytes(BMP280_SPI, reg_addr, num, bmp280_ncs);
 }
+#if (_STRIP_UNUSED_API_ == 0)
 /*/
  * @brief   init bmp280
  * */
@@ -68,6 +80,7 @@ uint8_t BMP280_ReadStatus()
 	else
 		return 0xFF;
 }
+#endif
 /*
  * @brief   set the data acquisition options bmp280
  *          register address: 0xF4, register name: ctrl_meas
@@ -113,6 +126,23 @@ void BMP280_GetCalibParam()
 	bmp280.calib_param.dig_t2 = ((int16_t)spiDataBuf[3] << 8) | spiDataBuf[2];
 	bmp280.calib_param.dig_t3 = ((int16_t)spiDataBuf[5] << 8) | spiDataBuf[4];
 
+#if (_MIN_FOOTPRINT_ == 1)
+	/* read 3 of dig_p1...dig_p9 each time, so spiDataBuf only needs 6 bytes */
+	bmp280_r_regs(BMP280_DIG_P1_LSB_REG, 6);
+	bmp280.calib_param.dig_p1 = ((uint16_t)spiDataBuf[1] << 8) | spiDataBuf[0];
+	bmp280.calib_param.dig_p2 = ((int16_t)spiDataBuf[3] << 8) | spiDataBuf[2];
+	bmp280.calib_param.dig_p3 = ((int16_t)spiDataBuf[5] << 8) | spiDataBuf[4];
+
+	bmp280_r_regs(BMP280_DIG_P4_LSB_REG, 6);
+	bmp280.calib_param.dig_p4 = ((int16_t)spiDataBuf[1] << 8) | spiDataBuf[0];
+	bmp280.calib_param.dig_p5 = ((int16_t)spiDataBuf[3] << 8) | spiDataBuf[2];
+	bmp280.calib_param.dig_p6 = ((int16_t)spiDataBuf[5] << 8) | spiDataBuf[4];
+
+	bmp280_r_regs(BMP280_DIG_P7_LSB_REG, 6);
+	bmp280.calib_param.dig_p7 = ((int16_t)spiDataBuf[1] << 8) | spiDataBuf[0];
+	bmp280.calib_param.dig_p8 = ((int16_t)spiDataBuf[3] << 8) | spiDataBuf[2];
+	bmp280.calib_param.dig_p9 = ((int16_t)spiDataBuf[5] << 8) | spiDataBuf[4];
+#else
 	bmp280_r_regs(BMP280_DIG_P1_LSB_REG, 18);
 	bmp280.calib_param.dig_p1 = ((uint16_t)spiDataBuf[1] << 8) | spiDataBuf[0];
 	bmp280.calib_param.dig_p2 = ((int16_t)spiDataBuf[3] << 8) | spiDataBuf[2];
@@ -123,6 +153,7 @@ void BMP280_GetCalibParam()
 	bmp280.calib_param.dig_p7 = ((int16_t)spiDataBuf[13] << 8) | spiDataBuf[12];
 	bmp280.calib_param.dig_p8 = ((int16_t)spiDataBuf[15] << 8) | spiDataBuf[14];
 	bmp280.calib_param.dig_p9 = ((int16_t)spiDataBuf[17] << 8) | spiDataBuf[16];
+#endif
 
 	bmp280_w_reg(BMP280_TRANSFER, BMP280_TRANSFER_ENABLE);
 }
@@ -134,14 +165,23 @@ void BMP280_GetCalibParam()
  * */
 void BMP280_Init()
 {
+#if (_MIN_FOOTPRINT_ == 0)
 	/* set CSB port and pin */
 	bmp280_ncs.port = BMP280_CSB_GPIO_Port;
 	bmp280_ncs.pin = BMP280_CSB_Pin;
+#endif
 
 	bmp280_w_reg(BMP280_RESET_REG, BMP280_RESET_VALUE);
 	BMP280_GetCalibParam();
 
+#if (_T_REUSE_MODE_ == 1)
+	bmp280.conf.os_temp = BMP280_T_REUSE_OS; // t_fine only, no need for x16
+	bmp280.t_reuse.period = 1;
+	bmp280.t_reuse.count = 0;
+	bmp280.t_reuse.last_adc_T = 0;
+#else
 	bmp280.conf.os_temp = BMP280_OS_x16;
+#endif
 	bmp280.conf.os_pres = BMP280_OS_x16;
 	bmp280.conf.odr = BMP280_ODR_62_5_MS;
 	bmp280.conf.filter = BMP280_Filter_Coeff_16;
@@ -158,12 +198,16 @@ void BMP280_Init()
  * */
 int32_t BMP280_ReadPressure_Row()
 {
+	int32_t adc_P;
 
 	bmp280_r_regs(BMP280_PRESSURE_MSB_REG, 3);
 
-	bmp280.uncomp_data.uncomp_press = ((uint32_t)spiDataBuf[0] << 12) | ((uint32_t)spiDataBuf[1] << 4) | ((uint32_t)spiDataBuf[2] >> 4);
+	adc_P = ((uint32_t)spiDataBuf[0] << 12) | ((uint32_t)spiDataBuf[1] << 4) | ((uint32_t)spiDataBuf[2] >> 4);
+#if (_MIN_FOOTPRINT_ == 0)
+	bmp280.uncomp_data.uncomp_press = adc_P;
+#endif
 
-	return bmp280.uncomp_data.uncomp_press;
+	return adc_P;
 }
 /*
  * @brief   register 0xFA...0xFC
@@ -173,16 +217,24 @@ int32_t BMP280_ReadPressure_Row()
  * */
 int32_t BMP280_ReadTemperature_Row()
 {
+	int32_t adc_T;
 
 	bmp280_r_regs(BMP280_TEMPERATURE_MSB_REG, 3);
 
-	bmp280.uncomp_data.uncomp_temp = ((uint32_t)spiDataBuf[0] << 12) | ((uint32_t)spiDataBuf[1] << 4) | ((uint32_t)spiDataBuf[2] >> 4);
+	adc_T = ((uint32_t)spiDataBuf[0] << 12) | ((uint32_t)spiDataBuf[1] << 4) | ((uint32_t)spiDataBuf[2] >> 4);
+#if (_MIN_FOOTPRINT_ == 0)
+	bmp280.uncomp_data.uncomp_temp = adc_T;
+#endif
+#if (_T_REUSE_MODE_ == 1)
+	bmp280.t_reuse.last_adc_T = adc_T;
+#endif
 
-	return bmp280.uncomp_data.uncomp_temp;
+	return adc_T;
 }
 /**** compensation formula functions ****/
 #if (_COMPENSATION_FORMULA_ == 0)
 /**** compensation formula in fixing point, system must support 64bit value ****/
+#if (_STRIP_UNUSED_API_ == 0)
 /*
  * @brief   calculate t_fine for BMP280_Compensate_P_32bit()
  * @notice  if BMP280_Compensate_T_32bit() has already been called, it's no need to call this function
@@ -192,17 +244,18 @@ int32_t BMP280_ReadTemperature_Row()
 float bmp280_calc_t_fine_int64()
 {
 	int32_t var1, var2;
-	int32_t adc_T = BMP280_ReadTemperature_Row(bmp);
+	int32_t adc_T = BMP280_ReadTemperature_Row();
 	var1 = ((((adc_T >> 3) - ((int32_t)bmp280.calib_param.dig_t1 << 1))) * ((int32_t)bmp280.calib_param.dig_t2)) >> 11;
 	var2 = (((((adc_T >> 4) - ((int32_t)bmp280.calib_param.dig_t1)) * ((adc_T >> 4) - ((int32_t)bmp280.calib_param.dig_t1))) >> 12) * ((int32_t)bmp280.calib_param.dig_t3)) >> 14;
 	bmp280.calib_param.t_fine = var1 + var2;
 	return bmp280.calib_param.t_fine;
 }
+#endif
 
 float BMP280_Compensate_T_int32()
 {
 	int32_t var1, var2, T;
-	int32_t adc_T = BMP280_ReadTemperature_Row(bmp);
+	int32_t adc_T = BMP280_ReadTemperature_Row();
 	var1 = ((((adc_T >> 3) - ((int32_t)bmp280.calib_param.dig_t1 << 1))) * ((int32_t)bmp280.calib_param.dig_t2)) >> 11;
 	var2 = (((((adc_T >> 4) - ((int32_t)bmp280.calib_param.dig_t1)) * ((adc_T >> 4) - ((int32_t)bmp280.calib_param.dig_t1))) >> 12) * ((int32_t)bmp280.calib_param.dig_t3)) >> 14;
 	bmp280.calib_param.t_fine = var1 + var2;
@@ -214,7 +267,7 @@ float BMP280_Compensate_T_int32()
 float BMP280_Compensate_P_int64()
 {
 	int64_t var1, var2, p;
-	int64_t adc_P = BMP280_ReadPressure_Row(bmp);
+	int64_t adc_P = BMP280_ReadPressure_Row();
 	var1 = ((int64_t)bmp280.calib_param.t_fine) - 128000;
 	var2 = var1 * var1 * (int64_t)bmp280.calib_param.dig_p6;
 	var2 = var2 + ((var1 * (int64_t)bmp280.calib_param.dig_p5) << 17);
@@ -236,6 +289,7 @@ float BMP280_Compensate_P_int64()
 /**** Computation formulae for 32 bit systems ****/
 #elif (_COMPENSATION_FORMULA_ == 1)
 /**** compensation formula in floating point ****/
+#if (_STRIP_UNUSED_API_ == 0)
 /*
  * @brief   use this function as use bmp_calc_t_fine_int32();
  * */
@@ -248,6 +302,7 @@ double bmp280_calc_t_fine_double()
 	bmp280.calib_param.t_fine = (int32_t)(var1 + var2);
 	return bmp280.calib_param.t_fine;
 }
+#endif
 
 double BMP280_Compensate_T_double()
 {
@@ -283,6 +338,7 @@ double BMP280_Compensate_P_double()
 }
 #elif (_COMPENSATION_FORMULA_ == 2)
 /**** compensation formula in fixing point ****/
+#if (_STRIP_UNUSED_API_ == 0)
 /*
  * @brief   use this function as use bmp_calc_t_fine_int32();
  * */
@@ -295,6 +351,7 @@ float bmp280_calc_t_fine_int32()
 	bmp280.calib_param.t_fine = var1 + var2;
 	return bmp280.calib_param.t_fine;
 }
+#endif
 float BMP280_Compensate_T_int32()
 {
 	int32_t var1, var2, T;
@@ -336,9 +393,46 @@ float BMP280_Compensate_P_int32()
 }
 #endif
 
+#if (_T_REUSE_MODE_ == 1)
+/*
+ * @brief   refresh temperature and t_fine when the reuse period runs out
+ *          the period doubles up to BMP280_T_REUSE_PERIOD while adc_T is stable,
+ *          and halves down to 1 when adc_T drifts more than BMP280_T_REUSE_DRIFT
+ * */
+static void bmp280_t_reuse_update()
+{
+	int32_t last_adc_T, drift;
+
+	if (bmp280.t_reuse.count == 0)
+	{
+		last_adc_T = bmp280.t_reuse.last_adc_T;
+		bmp280.comp_data.temp = BMP280_Compensate_T(); // updates t_reuse.last_adc_T
+		drift = bmp280.t_reuse.last_adc_T - last_adc_T;
+		if (drift < 0)
+			drift = -drift;
+
+		if (drift > BMP280_T_REUSE_DRIFT)
+			bmp280.t_reuse.period = (bmp280.t_reuse.period > 1) ? (bmp280.t_reuse.period >> 1) : 1;
+		else if (bmp280.t_reuse.period < BMP280_T_REUSE_PERIOD)
+			bmp280.t_reuse.period <<= 1;
+		bmp280.t_reuse.count = bmp280.t_reuse.period;
+	}
+	bmp280.t_reuse.count--;
+}
+#endif
+
+/*
+ * @brief   read and compensate temperature and pressure
+ *          if _T_REUSE_MODE_ is 1, only 3 pressure bytes are read on most samples
+ *          and comp_data.temp keeps the value of the last temperature read
+ * */
 void BMP280_ReadData()
 {
+#if (_T_REUSE_MODE_ == 1)
+	bmp280_t_reuse_update();
+#else
 	bmp280.comp_data.temp = BMP280_Compensate_T();
+#endif
 	bmp280.comp_data.press = BMP280_Compensate_P();
 }
 /* please check BST-BMP280-DS001-11 for more details */
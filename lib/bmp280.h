@@ -81,6 +81,26 @@ extern "C"
 #define BMP280_DIG_P9_LSB_REG (uint8_t)0x9E
 #define BMP280_DIG_P9_MSB_REG (uint8_t)0x9F
 
+/* 0: default profile
+ * 1: minimal footprint profile, packed config, no uncompensated data copy,
+ *    calibration read in 6-byte parts so spiDataBuf can be 6 bytes,
+ *    calibration itself stays raw since every formula uses all twelve dig_* values */
+#ifndef _MIN_FOOTPRINT_
+#define _MIN_FOOTPRINT_ 0
+#endif
+/* 1: remove bmp280_r_ChipId(), BMP280_ReadStatus() and bmp280_calc_t_fine()
+ *    only saves flash when the project does not link with -ffunction-sections and --gc-sections */
+#ifndef _STRIP_UNUSED_API_
+#define _STRIP_UNUSED_API_ _MIN_FOOTPRINT_
+#endif
+
+/* set SPI_DATABUF_SIZE in spi.h to this value */
+#if (_MIN_FOOTPRINT_ == 1)
+#define BMP280_SPI_DATABUF_SIZE 6 // dig_t1...dig_t3, or 3 of dig_p1...dig_p9
+#else
+#define BMP280_SPI_DATABUF_SIZE 18 // dig_p1...dig_p9
+#endif
+
 	/* following enums based on official manual */
 	/* set "ctrl_meas" register Bit[7:5] or Bit[4:2]*/
 	typedef enum __BMP280_Oversampling
@@ -152,6 +172,19 @@ extern "C"
 		int32_t t_fine;
 	} BMP280_CalibParam;
 	/* Sensor configuration structure */
+#if (_MIN_FOOTPRINT_ == 1)
+	/* same fields packed in 2 bytes, in register bit order */
+	typedef struct __BMP280_ConfigOption
+	{
+		uint8_t power_mode : 2; // ctrl_meas Bit[1:0]
+		uint8_t os_pres : 3;	// ctrl_meas Bit[4:2]
+		uint8_t os_temp : 3;	// ctrl_meas Bit[7:5]
+		uint8_t spi3w_en : 1;	// config Bit[0]
+		uint8_t : 1;
+		uint8_t filter : 3; // config Bit[4:2]
+		uint8_t odr : 3;	// config Bit[7:5]
+	} BMP280_ConfigOption;
+#else
 	typedef struct __BMP280_ConfigOption
 	{
 		uint8_t os_temp;
@@ -161,6 +194,7 @@ extern "C"
 		uint8_t spi3w_en;
 		uint8_t power_mode;
 	} BMP280_ConfigOption;
+#endif
 	/* Sensor status structure */
 	typedef struct __BMP280_Status
 	{
@@ -179,54 +213,95 @@ extern "C"
 		float temp;
 		float press;
 	} BMP280_CompData;
+
+/* 0: read temperature and pressure on every BMP280_ReadData()
+ * 1: read pressure only and reuse cached t_fine, refresh temperature periodically */
+#ifndef _T_REUSE_MODE_
+#define _T_REUSE_MODE_ 0
+#endif
+#if (_T_REUSE_MODE_ == 1)
+#ifndef BMP280_T_REUSE_PERIOD
+#define BMP280_T_REUSE_PERIOD 16 // max samples between two temperature reads, power of 2
+#endif
+#ifndef BMP280_T_REUSE_DRIFT
+#define BMP280_T_REUSE_DRIFT 64 // raw adc_T drift which shortens the period, about 0.02 cel
+#endif
+#ifndef BMP280_T_REUSE_OS
+#define BMP280_T_REUSE_OS BMP280_OS_x2 // set to BMP280_OS_x16 to keep full temperature resolution
+#endif
+
+	/* t_fine reuse state structure */
+	typedef struct __BMP280_TReuse
+	{
+		uint8_t period; // current samples between two temperature reads
+		uint8_t count;	// samples left before next temperature read
+		int32_t last_adc_T;
+	} BMP280_TReuse;
+#endif
+
 	/* device structure */
 	typedef struct __BMP280
 	{
 		BMP280_CalibParam calib_param;
 		BMP280_ConfigOption conf;
+#if (_MIN_FOOTPRINT_ == 0)
 		BMP280_UncompData uncomp_data;
+#endif
 		BMP280_CompData comp_data;
+#if (_T_REUSE_MODE_ == 1)
+		BMP280_TReuse t_reuse;
+#endif
 	} BMP280;
 
 	extern BMP280 bmp280;
 
+#if (_STRIP_UNUSED_API_ == 0)
 	uint8_t bmp280_r_ChipId();
+	uint8_t BMP280_ReadStatus();
+#endif
 	void BMP280_Set_RegCtrlMeas();
 	void BMP280_Set_RegConfig();
 	void BMP280_Config();
 	void BMP280_Init();
-	uint8_t BMP280_ReadStatus();
 	int32_t BMP280_ReadPressure_Row();
 	int32_t BMP280_ReadTemperature_Row();
 
+#ifndef _COMPENSATION_FORMULA_
 #define _COMPENSATION_FORMULA_ 1
+#endif
 /* 64bit fixing point */
 #if (_COMPENSATION_FORMULA_ == 0)
+#if (_STRIP_UNUSED_API_ == 0)
 #define bmp280_calc_t_fine() bmp280_calc_t_fine_int64()
+	float bmp280_calc_t_fine_int64();
+#endif
 #define BMP280_Compensate_T() BMP280_Compensate_T_int32()
 #define BMP280_Compensate_P() BMP280_Compensate_P_int64()
 
-	float bmp280_calc_t_fine_int64();
 	float BMP280_Compensate_T_int32();
 	float BMP280_Compensate_P_int64();
 
 /* 32bit floating point */
 #elif (_COMPENSATION_FORMULA_ == 1)
+#if (_STRIP_UNUSED_API_ == 0)
 #define bmp280_calc_t_fine() bmp280_calc_t_fine_double()
+double bmp280_calc_t_fine_double();
+#endif
 #define BMP280_Compensate_T() BMP280_Compensate_T_double()
 #define BMP280_Compensate_P() BMP280_Compensate_P_double()
 
-double bmp280_calc_t_fine_double();
 double BMP280_Compensate_T_double();
 double BMP280_Compensate_P_double();
 
 /* 32bit fixing point */
 #elif (_COMPENSATION_FORMULA_ == 2)
+#if (_STRIP_UNUSED_API_ == 0)
 #define bmp280_calc_t_fine() bmp280_calc_t_fine_int32()
+float bmp280_calc_t_fine_int32();
+#endif
 #define BMP280_Compensate_T() BMP280_Compensate_T_int32()
 #define BMP280_Compensate_P() BMP280_Compensate_P_int32()
 
-float bmp280_calc_t_fine_int32();
 float BMP280_Compensate_T_int32();
 float BMP280_Compensate_P_int32();
 #endif
@@ -0,0 +1,103 @@
+#!/bin/sh
+# report flash/RAM usage of lib/bmp280.c for each build variant
+#
+# usage:   tools/bmp280_footprint.sh
+# env:     CROSS_COMPILE  toolchain prefix, default arm-none-eabi-
+#          CFLAGS         target flags, default -mcpu=cortex-m0plus -mthumb -Os
+#          LDFLAGS        link flags, default --specs=nano.specs --specs=nosys.specs
+#
+# obj columns are lib/bmp280.c alone.
+# link columns are a program calling BMP280_Init() and BMP280_ReadData() minus an empty one,
+# so they add spiDataBuf and what the variant pulls from libgcc (soft float, 64bit division).
+# HAL is replaced by empty stubs, so main.h and spi.h of the project are not needed.
+#
+# the link uses --gc-sections, which already drops the functions _STRIP_UNUSED_API_ removes,
+# so strip only shows up in obj columns. link columns can move a few bytes from alignment.
+
+CROSS_COMPILE=${CROSS_COMPILE-arm-none-eabi-}
+CC=${CROSS_COMPILE}gcc
+SIZE=${CROSS_COMPILE}size
+CFLAGS=${CFLAGS-"-mcpu=cortex-m0plus -mthumb -Os"}
+LDFLAGS=${LDFLAGS-"--specs=nano.specs --specs=nosys.specs"}
+CFLAGS="$CFLAGS -std=gnu11 -ffunction-sections -fdata-sections"
+LDFLAGS="$LDFLAGS -Wl,--gc-sections"
+
+LIB_DIR=$(cd "$(dirname "$0")/../lib" && pwd)
+TMP_DIR=$(mktemp -d)
+trap 'rm -rf "$TMP_DIR"' EXIT
+
+cat >"$TMP_DIR/main.h" <<'EOF'
+#include <stdint.h>
+typedef struct { uint32_t reg; } GPIO_TypeDef;
+typedef struct { uint32_t reg; } SPI_HandleTypeDef;
+#define BMP280_CSB_GPIO_Port ((GPIO_TypeDef *)0x48000400)
+#define BMP280_CSB_Pin ((uint16_t)0x1000)
+EOF
+
+cat >"$TMP_DIR/spi.h" <<'EOF'
+#ifndef SPI_DATABUF_SIZE
+#define SPI_DATABUF_SIZE 18
+#endif
+typedef struct __NCS_IO
+{
+    GPIO_TypeDef *port;
+    uint16_t pin;
+} ncs_io;
+extern SPI_HandleTypeDef hspi2;
+extern uint8_t spiDataBuf[SPI_DATABUF_SIZE];
+void spi_w_byte(SPI_HandleTypeDef *hspi, uint8_t address, uint8_t byte, ncs_io cs);
+void spi_r_bytes(SPI_HandleTypeDef *hspi, uint8_t address, uint8_t num, ncs_io cs);
+EOF
+
+cat >"$TMP_DIR/stub.c" <<'EOF'
+#include "main.h"
+#include "spi.h"
+SPI_HandleTypeDef hspi2;
+uint8_t spiDataBuf[SPI_DATABUF_SIZE];
+void spi_w_byte(SPI_HandleTypeDef *hspi, uint8_t address, uint8_t byte, ncs_io cs) {}
+void spi_r_bytes(SPI_HandleTypeDef *hspi, uint8_t address, uint8_t num, ncs_io cs) {}
+void BMP280_Init();
+void BMP280_ReadData();
+int main()
+{
+#ifndef BASELINE
+    BMP280_Init();
+    BMP280_ReadData();
+#endif
+    return 0;
+}
+EOF
+
+# print "flash ram" of a file from size output
+flash_ram()
+{
+    $SIZE "$1" | awk 'NR == 2 { print $1 + $2, $2 + $3 }'
+}
+
+# $1 formula, $2 min footprint, $3 t_fine reuse, $4 strip unused api
+report()
+{
+    defs="-D_COMPENSATION_FORMULA_=$1 -D_MIN_FOOTPRINT_=$2 -D_T_REUSE_MODE_=$3 -D_STRIP_UNUSED_API_=$4"
+    if [ "$2" = 1 ]; then
+        defs="$defs -DSPI_DATABUF_SIZE=6"
+    fi
+
+    $CC $CFLAGS $defs -I"$TMP_DIR" -I"$LIB_DIR" -c "$LIB_DIR/bmp280.c" -o "$TMP_DIR/bmp280.o" || exit 1
+    $CC $CFLAGS $defs -I"$TMP_DIR" -c "$TMP_DIR/stub.c" -o "$TMP_DIR/stub.o" || exit 1
+    $CC $CFLAGS $defs -DBASELINE -I"$TMP_DIR" -c "$TMP_DIR/stub.c" -o "$TMP_DIR/base.o" || exit 1
+    $CC $CFLAGS $LDFLAGS "$TMP_DIR/stub.o" "$TMP_DIR/bmp280.o" -o "$TMP_DIR/full.elf" || exit 1
+    $CC $CFLAGS $LDFLAGS "$TMP_DIR/base.o" -o "$TMP_DIR/base.elf" || exit 1
+
+    set -- "$1" "$2" "$3" "$4" $(flash_ram "$TMP_DIR/bmp280.o") $(flash_ram "$TMP_DIR/full.elf") $(flash_ram "$TMP_DIR/base.elf")
+    printf "%7s %4s %5s %5s | %9s %7s | %10s %8s\n" "$1" "$2" "$3" "$4" "$5" "$6" $(($7 - $9)) $(($8 - ${10}))
+}
+
+printf "%7s %4s %5s %5s | %9s %7s | %10s %8s\n" formula min reuse strip "obj flash" "obj ram" "link flash" "link ram"
+for formula in 0 1 2; do
+    for reuse in 0 1; do
+        report $formula 0 $reuse 0
+        report $formula 0 $reuse 1
+        report $formula 1 $reuse 0
+        report $formula 1 $reuse 1
+    done
+done
@@ -0,0 +1,155 @@
+#!/bin/sh
+# simulate _T_REUSE_MODE_ on host across linear temperature ramps
+#
+# usage:   tools/bmp280_t_reuse_sim.sh
+# env:     CC       host compiler, default gcc
+#          FORMULA  _COMPENSATION_FORMULA_, default 1
+#          PERIOD   BMP280_T_REUSE_PERIOD, default 16
+#          DRIFT    BMP280_T_REUSE_DRIFT, default 64
+#
+# lib/bmp280.c runs against a fake SPI bus holding the calibration example of the datasheet
+# (page 23), sampled at 10Hz for 600s or until the ramp reaches 85cel. every sample is also compensated with a fresh t_fine to get the error.
+# bytes/sample counts SPI bytes of BMP280_ReadData() including the address byte, default mode is 8.
+# t_comp/sample counts temperature reads and compensations, default mode is 1. this is the host-side
+# proxy for the cycles saved, the real cycle count depends on the MCU and was not measured.
+
+CC=${CC-gcc}
+FORMULA=${FORMULA-1}
+PERIOD=${PERIOD-16}
+DRIFT=${DRIFT-64}
+
+LIB_DIR=$(cd "$(dirname "$0")/../lib" && pwd)
+TMP_DIR=$(mktemp -d)
+trap 'rm -rf "$TMP_DIR"' EXIT
+
+cat >"$TMP_DIR/main.h" <<'EOT'
+#include <stdint.h>
+typedef struct { uint32_t reg; } GPIO_TypeDef;
+typedef struct { uint32_t reg; } SPI_HandleTypeDef;
+#define BMP280_CSB_GPIO_Port ((GPIO_TypeDef *)0)
+#define BMP280_CSB_Pin ((uint16_t)0)
+EOT
+
+cat >"$TMP_DIR/spi.h" <<'EOT'
+#define SPI_DATABUF_SIZE 18
+typedef struct __NCS_IO
+{
+    GPIO_TypeDef *port;
+    uint16_t pin;
+} ncs_io;
+extern SPI_HandleTypeDef hspi2;
+extern uint8_t spiDataBuf[SPI_DATABUF_SIZE];
+void spi_w_byte(SPI_HandleTypeDef *hspi, uint8_t address, uint8_t byte, ncs_io cs);
+void spi_r_bytes(SPI_HandleTypeDef *hspi, uint8_t address, uint8_t num, ncs_io cs);
+EOT
+
+cat >"$TMP_DIR/sim.c" <<'EOT'
+#include <stdio.h>
+#include <string.h>
+#include "bmp280.h"
+
+#define SAMPLE_HZ 10
+#define SAMPLES 6000
+#define MAX_CEL 85 // stop a ramp at the top of the operating range
+#define ADC_T_25_CEL 519888 // datasheet example, 25.08 cel
+#define ADC_P 415148
+
+SPI_HandleTypeDef hspi2;
+uint8_t spiDataBuf[SPI_DATABUF_SIZE];
+static uint8_t regs[256];
+static uint32_t bus_bytes, t_reads;
+
+static void set_adc(uint8_t reg, int32_t adc)
+{
+    regs[reg] = adc >> 12;
+    regs[reg + 1] = adc >> 4;
+    regs[reg + 2] = adc << 4;
+}
+
+static void set_word(uint8_t reg, int16_t word)
+{
+    regs[reg] = word;
+    regs[reg + 1] = (uint16_t)word >> 8;
+}
+
+void spi_w_byte(SPI_HandleTypeDef *hspi, uint8_t address, uint8_t byte, ncs_io cs)
+{
+    bus_bytes += 2;
+}
+
+void spi_r_bytes(SPI_HandleTypeDef *hspi, uint8_t address, uint8_t num, ncs_io cs)
+{
+    memcpy(spiDataBuf, &regs[address], num);
+    bus_bytes += 1 + num;
+    if (address == BMP280_TEMPERATURE_MSB_REG)
+        t_reads++;
+}
+
+/* pressure with a fresh t_fine, does not change the reuse state */
+static double fresh_pressure()
+{
+    int32_t t_fine = bmp280.calib_param.t_fine;
+    int32_t last_adc_T = bmp280.t_reuse.last_adc_T;
+    double press;
+
+    bmp280_calc_t_fine();
+    press = (float)BMP280_Compensate_P();
+    bmp280.calib_param.t_fine = t_fine;
+    bmp280.t_reuse.last_adc_T = last_adc_T;
+    return press;
+}
+
+int main()
+{
+    static const int16_t calib[12] = {27504, 26435, -1000, 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000};
+    static const double ramps[] = {0.0, 0.01, 0.1, 0.5, 2.0}; // cel per second
+    double lsb_per_cel, press, err, max_err;
+    uint32_t r, s, i, samples;
+
+    for (i = 0; i < 12; i++)
+        set_word(BMP280_DIG_T1_LSB_REG + 2 * i, calib[i]);
+    set_adc(BMP280_PRESSURE_MSB_REG, ADC_P);
+
+    /* adc_T slope of this calibration around 25 cel */
+    BMP280_Init();
+    set_adc(BMP280_TEMPERATURE_MSB_REG, ADC_T_25_CEL + 16384);
+    lsb_per_cel = BMP280_Compensate_T();
+    set_adc(BMP280_TEMPERATURE_MSB_REG, ADC_T_25_CEL);
+    lsb_per_cel = 16384 / (lsb_per_cel - BMP280_Compensate_T());
+
+    printf("formula %d, period %d, drift %d LSB (%.3f cel)\n", _COMPENSATION_FORMULA_,
+           BMP280_T_REUSE_PERIOD, BMP280_T_REUSE_DRIFT, BMP280_T_REUSE_DRIFT / lsb_per_cel);
+    printf("%9s | %12s %13s %14s\n", "cel/s", "bytes/sample", "t_comp/sample", "max error(Pa)");
+    for (r = 0; r < sizeof(ramps) / sizeof(ramps[0]); r++)
+    {
+        memset(&bmp280, 0, sizeof(bmp280));
+        BMP280_Init();
+        bus_bytes = 0;
+        t_reads = 0;
+        max_err = 0;
+        samples = SAMPLES;
+        if (ramps[r] > 0 && (MAX_CEL - 25) / ramps[r] * SAMPLE_HZ < SAMPLES)
+            samples = (MAX_CEL - 25) / ramps[r] * SAMPLE_HZ;
+        for (s = 0; s < samples; s++)
+        {
+            set_adc(BMP280_TEMPERATURE_MSB_REG, ADC_T_25_CEL + (int32_t)(ramps[r] * s / SAMPLE_HZ * lsb_per_cel));
+            BMP280_ReadData();
+            press = bmp280.comp_data.press; // fresh_pressure() may overwrite comp_data
+            err = press - fresh_pressure();
+            if (err < 0)
+                err = -err;
+            if (err > max_err)
+                max_err = err;
+        }
+        /* fresh_pressure() reads temperature and pressure, 8 bytes once per sample */
+        printf("%9.2f | %12.2f %13.3f %14.2f\n", ramps[r], (double)(bus_bytes - 8 * samples) / samples,
+               (double)(t_reads - samples) / samples, max_err);
+    }
+    return 0;
+}
+EOT
+
+$CC -std=gnu11 -O2 -D_T_REUSE_MODE_=1 -D_STRIP_UNUSED_API_=0 -D_COMPENSATION_FORMULA_=$FORMULA \
+    -DBMP280_T_REUSE_PERIOD=$PERIOD -DBMP280_T_REUSE_DRIFT=$DRIFT \
+    -I"$TMP_DIR" -I"$LIB_DIR" "$TMP_DIR/sim.c" "$LIB_DIR/bmp280.c" -o "$TMP_DIR/sim" -lm || exit 1
+"$TMP_DIR/sim"